@@ -1,6 +1,10 @@
 #include <iostream>
 #include <vector>
 #include <map>
+#include <set>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include <algorithm>
 #include <iomanip>
@@ -8,6 +12,14 @@
 #include <ctime>
 #include <limits>
 #include <cmath>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <fstream>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 
@@ -17,6 +29,8 @@ enum SplitType {
     CUSTOM_WEIGHT
 };
 
+const int SPLIT_TYPE_COUNT = CUSTOM_WEIGHT + 1; // must follow the last SplitType
+
 struct Transaction {
     int id;
     string payer;
@@ -51,6 +65,7 @@ struct Settlement {
     double amount;
     string date;
     string groupName;
+    int sequence = 0; // global recording order across all partitions
     
     Settlement(int _transactionId, string _from, string _to, double _amount, string _groupName = "") 
         : transactionId(_transactionId), from(_from), to(_to), amount(_amount), groupName(_groupName) {
@@ -61,15 +76,652 @@ struct Settlement {
     }
 };
 
-class SplitWiseApp {
+// Scores per person kept in value order, so the K largest or smallest
+// entries are read off either end of the set after O(log N) updates.
+class Leaderboard {
 private:
+    unordered_map<string, double> values;
+    set<pair<double, string>> ordered;
+    
+public:
+    // Non-finite deltas are ignored; a NaN key would break the set's ordering
+    void adjust(const string& name, double delta) {
+        if (!isfinite(delta)) return;
+        
+        auto it = values.find(name);
+        if (it == values.end()) {
+            it = values.emplace(name, 0.0).first;
+        } else {
+            ordered.erase({it->second, name});
+        }
+        it->second += delta;
+        ordered.insert({it->second, name});
+    }
+    
+    // Up to k entries with value above threshold, largest first
+    vector<pair<string, double>> top(size_t k, double threshold = 0.01) const {
+        vector<pair<string, double>> result;
+        for (auto it = ordered.rbegin(); it != ordered.rend() && result.size() < k; ++it) {
+            if (it->first <= threshold) break;
+            result.push_back({it->second, it->first});
+        }
+        return result;
+    }
+    
+    // Up to k entries with value below -threshold, smallest first
+    vector<pair<string, double>> bottom(size_t k, double threshold = 0.01) const {
+        vector<pair<string, double>> result;
+        for (auto it = ordered.begin(); it != ordered.end() && result.size() < k; ++it) {
+            if (it->first >= -threshold) break;
+            result.push_back({it->second, it->first});
+        }
+        return result;
+    }
+};
+
+// Pre-aggregated totals for one group and month
+struct MonthRollup {
+    double totalSpend = 0;
+    int transactionCount = 0;
+    double spendBySplitType[SPLIT_TYPE_COUNT] = {}; // indexed by SplitType
+    
+    void merge(const MonthRollup& other) {
+        totalSpend += other.totalSpend;
+        transactionCount += other.transactionCount;
+        for (int i = 0; i < SPLIT_TYPE_COUNT; i++) {
+            spendBySplitType[i] += other.spendBySplitType[i];
+        }
+    }
+};
+
+// Pre-aggregated totals for one person within a group and month
+struct PersonRollup {
+    double paid = 0;        // amount paid as the payer
+    double consumed = 0;    // own share of transactions
+    double settledOut = 0;  // settlements paid to others
+    double settledIn = 0;   // settlements received
+    
+    void merge(const PersonRollup& other) {
+        paid += other.paid;
+        consumed += other.consumed;
+        settledOut += other.settledOut;
+        settledIn += other.settledIn;
+    }
+};
+
+// All transactions and settlements belonging to one group.
+// Partition 0 always holds personal (non-group) items.
+struct GroupLedger {
+    string name;
     vector<Transaction> transactions;
     vector<Settlement> settlements;
-    vector<string> groups;
+    Leaderboard balances;   // net balance of unsettled items in this group
+    Leaderboard spending;   // total amount paid per person in this group
+    map<string, MonthRollup> monthly;                     // "YYYY-MM" -> totals
+    map<pair<string, string>, PersonRollup> personMonthly; // ("YYYY-MM", person) -> totals
+    
+    GroupLedger(string _name) : name(_name) {}
+};
+
+// Trigram inverted index over transaction descriptions (case-insensitive).
+// Each posting list stores ascending transaction IDs as varint-encoded deltas.
+// Removals are lazy: removed IDs are tombstoned and only dropped from the
+// posting lists once they make up half the index.
+class DescriptionIndex {
+private:
+    static const size_t SKIP_INTERVAL = 64; // postings per skip block
+    
+    struct PostingList {
+        struct Skip {
+            int base;       // ID preceding the block (0 for the first)
+            size_t offset;  // byte offset where the block starts
+        };
+        
+        vector<uint8_t> bytes;
+        vector<Skip> skips; // one entry per SKIP_INTERVAL postings
+        int lastId = 0;
+        size_t count = 0;
+        
+        static uint32_t readVarint(const vector<uint8_t>& bytes, size_t& pos) {
+            uint32_t value = 0;
+            int shift = 0;
+            while (bytes[pos] & 0x80) {
+                value |= static_cast<uint32_t>(bytes[pos++] & 0x7F) << shift;
+                shift += 7;
+            }
+            value |= static_cast<uint32_t>(bytes[pos++]) << shift;
+            return value;
+        }
+        
+        void append(int id) {
+            if (count % SKIP_INTERVAL == 0) skips.push_back({lastId, bytes.size()});
+            
+            uint32_t delta = id - lastId;
+            while (delta >= 0x80) {
+                bytes.push_back(static_cast<uint8_t>(delta | 0x80));
+                delta >>= 7;
+            }
+            bytes.push_back(static_cast<uint8_t>(delta));
+            lastId = id;
+            count++;
+        }
+        
+        vector<int> decode() const {
+            vector<int> ids;
+            ids.reserve(count);
+            int id = 0;
+            size_t pos = 0;
+            while (pos < bytes.size()) {
+                id += readVarint(bytes, pos);
+                ids.push_back(id);
+            }
+            return ids;
+        }
+    };
+    
+    // Forward-only membership probe over a posting list. Skip entries jump
+    // whole blocks, so only the block that could hold the ID is decoded.
+    class PostingCursor {
+    private:
+        const PostingList* list;
+        size_t block = 0;   // block holding the next posting
+        size_t pos = 0;     // byte offset of the next posting
+        int current = 0;    // last ID decoded
+        
+    public:
+        PostingCursor(const PostingList* _list) : list(_list) {}
+        
+        // IDs must be probed in ascending order
+        bool contains(int id) {
+            const vector<PostingList::Skip>& skips = list->skips;
+            
+            // Jump to the last block whose preceding ID is below id
+            if (block + 1 < skips.size() && skips[block + 1].base < id) {
+                auto next = lower_bound(skips.begin() + block + 1, skips.end(), id,
+                                        [](const PostingList::Skip& s, int value) { return s.base < value; });
+                block = next - skips.begin() - 1;
+                pos = skips[block].offset;
+                current = skips[block].base;
+            }
+            
+            while (current < id && pos < list->bytes.size()) {
+                current += PostingList::readVarint(list->bytes, pos);
+                if (block + 1 < skips.size() && pos == skips[block + 1].offset) block++;
+            }
+            return current == id;
+        }
+    };
+    
+    unordered_map<uint32_t, PostingList> postings;
+    unordered_set<int> tombstones; // removed IDs still present in postings
+    size_t indexedCount = 0;       // IDs added and not yet compacted away
+    
+    void compact() {
+        for (auto it = postings.begin(); it != postings.end();) {
+            PostingList rebuilt;
+            for (int existing : it->second.decode()) {
+                if (!tombstones.count(existing)) rebuilt.append(existing);
+            }
+            if (rebuilt.count == 0) {
+                it = postings.erase(it);
+            } else {
+                it->second = move(rebuilt);
+                ++it;
+            }
+        }
+        indexedCount -= tombstones.size();
+        tombstones.clear();
+    }
+    
+    static vector<uint32_t> trigramsOf(const string& text) {
+        string lower = normalize(text);
+        vector<uint32_t> grams;
+        for (size_t i = 0; i + 3 <= lower.size(); i++) {
+            grams.push_back(static_cast<uint8_t>(lower[i]) << 16 |
+                            static_cast<uint8_t>(lower[i + 1]) << 8 |
+                            static_cast<uint8_t>(lower[i + 2]));
+        }
+        sort(grams.begin(), grams.end());
+        grams.erase(unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+    
+public:
+    static string normalize(const string& text) {
+        string lower = text;
+        transform(lower.begin(), lower.end(), lower.begin(),
+                  [](unsigned char c) { return tolower(c); });
+        return lower;
+    }
+    
+    // Queries shorter than a trigram cannot use the index
+    static bool canIndex(const string& query) {
+        return query.size() >= 3;
+    }
+    
+    // IDs must be added in increasing order
+    void add(int id, const string& description) {
+        for (uint32_t gram : trigramsOf(description)) {
+            postings[gram].append(id);
+        }
+        indexedCount++;
+    }
+    
+    // IDs must not be reused after removal
+    void remove(int id) {
+        tombstones.insert(id);
+        if (tombstones.size() * 2 > indexedCount) compact();
+    }
+    
+    // Length of the shortest posting list among the query's trigrams, an
+    // upper bound on how many candidates the index would return
+    size_t rarestPostingSize(const string& query) const {
+        size_t rarest = numeric_limits<size_t>::max();
+        for (uint32_t gram : trigramsOf(query)) {
+            auto it = postings.find(gram);
+            if (it == postings.end()) return 0;
+            rarest = min(rarest, it->second.count);
+        }
+        return rarest;
+    }
+    
+    // IDs whose description contains every trigram of the query, ascending.
+    // Candidates still need a substring check to rule out scattered trigrams.
+    vector<int> candidates(const string& query) const {
+        vector<const PostingList*> lists;
+        for (uint32_t gram : trigramsOf(query)) {
+            auto it = postings.find(gram);
+            if (it == postings.end()) return {};
+            lists.push_back(&it->second);
+        }
+        if (lists.empty()) return {};
+        
+        // Decode only the rarest trigram's list and probe the others for each
+        // of its IDs, so the cost follows the rarest list rather than the largest
+        sort(lists.begin(), lists.end(),
+             [](const PostingList* a, const PostingList* b) { return a->count < b->count; });
+        
+        vector<PostingCursor> others(lists.begin() + 1, lists.end());
+        vector<int> result;
+        for (int id : lists[0]->decode()) {
+            if (tombstones.count(id)) continue;
+            
+            bool inAll = true;
+            for (auto& cursor : others) {
+                if (!cursor.contains(id)) {
+                    inAll = false;
+                    break;
+                }
+            }
+            if (inAll) result.push_back(id);
+        }
+        return result;
+    }
+};
+
+// Filters for findTransactions; empty strings match anything
+struct TransactionQuery {
+    string description;
+    string person;
+    string groupName;
+    double minAmount = -numeric_limits<double>::infinity();
+    double maxAmount = numeric_limits<double>::infinity();
+    bool personalOnly = false; // only non-group transactions
+};
+
+class SplitWiseApp {
+private:
+    vector<GroupLedger> ledgers;                 // [0] = personal, then groups in creation order
+    unordered_map<string, size_t> groupIndex;    // group name -> index into ledgers
+    unordered_map<int, size_t> transactionLedger; // transaction id -> index into ledgers
+    DescriptionIndex descriptionIndex;
+    Leaderboard globalBalances;
+    Leaderboard globalSpending;
     int nextTransactionId;
+    int nextSettlementSequence;
+    
+    // Returns the ledger for a group, creating it if needed
+    GroupLedger& ledgerFor(const string& groupName) {
+        if (groupName.empty()) return ledgers[0];
+        
+        auto it = groupIndex.find(groupName);
+        if (it != groupIndex.end()) return ledgers[it->second];
+        
+        groupIndex[groupName] = ledgers.size();
+        ledgers.emplace_back(groupName);
+        return ledgers.back();
+    }
+    
+    const GroupLedger* findLedger(const string& groupName) const {
+        if (groupName.empty()) return &ledgers[0];
+        
+        auto it = groupIndex.find(groupName);
+        return it == groupIndex.end() ? nullptr : &ledgers[it->second];
+    }
+    
+    bool hasGroup(const string& groupName) const {
+        return groupIndex.find(groupName) != groupIndex.end();
+    }
+    
+    const Transaction* findTransaction(int id) const {
+        auto owner = transactionLedger.find(id);
+        if (owner == transactionLedger.end()) return nullptr;
+        
+        // IDs are ascending within a ledger, so binary search it
+        const vector<Transaction>& list = ledgers[owner->second].transactions;
+        auto it = lower_bound(list.begin(), list.end(), id,
+                              [](const Transaction& t, int value) { return t.id < value; });
+        return it != list.end() && it->id == id ? &*it : nullptr;
+    }
+    
+    static bool matchesQuery(const Transaction& t, const TransactionQuery& query, const string& needle) {
+        if (!query.groupName.empty() && t.groupName != query.groupName) return false;
+        if (query.personalOnly && !t.groupName.empty()) return false;
+        if (t.amount < query.minAmount || t.amount > query.maxAmount) return false;
+        if (!query.person.empty() && t.payer != query.person &&
+            find(t.participants.begin(), t.participants.end(), query.person) == t.participants.end()) {
+            return false;
+        }
+        if (!needle.empty() && DescriptionIndex::normalize(t.description).find(needle) == string::npos) {
+            return false;
+        }
+        return true;
+    }
+    
+    // Visits one list from every partition in ascending key order.
+    // Each ledger's list is already ascending, so this merges them instead of sorting.
+    template <typename Item, typename Key, typename Visitor>
+    void mergeLedgers(vector<Item> GroupLedger::*member, Key key, Visitor visit) const {
+        // (next key, (ledger index, position)) for each ledger not yet exhausted
+        typedef pair<int, pair<size_t, size_t>> Cursor;
+        priority_queue<Cursor, vector<Cursor>, greater<Cursor>> heads;
+        for (size_t i = 0; i < ledgers.size(); i++) {
+            if (!(ledgers[i].*member).empty()) {
+                heads.push({key((ledgers[i].*member)[0]), {i, 0}});
+            }
+        }
+        
+        while (!heads.empty()) {
+            size_t ledger = heads.top().second.first;
+            size_t pos = heads.top().second.second;
+            heads.pop();
+            
+            const vector<Item>& list = ledgers[ledger].*member;
+            visit(list[pos]);
+            if (++pos < list.size()) heads.push({key(list[pos]), {ledger, pos}});
+        }
+    }
+    
+    // Every transaction across all partitions, in ID (creation) order
+    template <typename Visitor>
+    void forEachTransaction(Visitor visit) const {
+        mergeLedgers(&GroupLedger::transactions, [](const Transaction& t) { return t.id; }, visit);
+    }
+    
+    // Every settlement across all partitions, in recording order
+    template <typename Visitor>
+    void forEachSettlement(Visitor visit) const {
+        mergeLedgers(&GroupLedger::settlements, [](const Settlement& s) { return s.sequence; }, visit);
+    }
+    
+    void printGroups() const {
+        cout << "Available groups: ";
+        for (size_t i = 1; i < ledgers.size(); i++) {
+            cout << ledgers[i].name << " ";
+        }
+    }
+    
+    // Amount each participant owes for a transaction, aligned with participants
+    static vector<double> participantShares(const Transaction& transaction) {
+        vector<double> shares(transaction.participants.size(), 0.0);
+        
+        switch (transaction.splitType) {
+            case EQUAL:
+                for (size_t i = 0; i < shares.size(); i++) {
+                    shares[i] = transaction.amount / transaction.participants.size();
+                }
+                break;
+                
+            case PERCENTAGE:
+                for (size_t i = 0; i < shares.size(); i++) {
+                    shares[i] = transaction.amount * (transaction.weights[i] / 100.0);
+                }
+                break;
+                
+            case CUSTOM_WEIGHT:
+                {
+                    double totalWeight = 0;
+                    for (double weight : transaction.weights) {
+                        totalWeight += weight;
+                    }
+                    // All-zero weights carry no information, so split equally
+                    for (size_t i = 0; i < shares.size(); i++) {
+                        shares[i] = totalWeight == 0 ? transaction.amount / shares.size()
+                                                     : transaction.amount * (transaction.weights[i] / totalWeight);
+                    }
+                }
+                break;
+        }
+        
+        return shares;
+    }
+    
+    // "YYYY-MM" bucket for a ctime-formatted date such as "Sun Oct 18 12:06:40 2026"
+    static string monthBucket(const string& date) {
+        static const string months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+        
+        if (date.size() < 24) return "unknown";
+        size_t month = months.find(date.substr(4, 3));
+        if (month == string::npos) return "unknown";
+        
+        stringstream ss;
+        ss << date.substr(date.size() - 4) << "-" << setw(2) << setfill('0') << month / 3 + 1;
+        return ss.str();
+    }
+    
+    // Apply (sign = 1) or revert (sign = -1) a transaction in the rollups
+    void updateRollups(GroupLedger& ledger, const Transaction& transaction, double sign) {
+        string month = monthBucket(transaction.date);
+        
+        MonthRollup& cell = ledger.monthly[month];
+        cell.totalSpend += sign * transaction.amount;
+        cell.transactionCount += static_cast<int>(sign);
+        cell.spendBySplitType[transaction.splitType] += sign * transaction.amount;
+        
+        ledger.personMonthly[{month, transaction.payer}].paid += sign * transaction.amount;
+        
+        vector<double> shares = participantShares(transaction);
+        for (size_t i = 0; i < shares.size(); i++) {
+            ledger.personMonthly[{month, transaction.participants[i]}].consumed += sign * shares[i];
+        }
+    }
+    
+    // Apply (sign = 1) or revert (sign = -1) a transaction in the leaderboards
+    void updateLeaderboards(GroupLedger& ledger, const Transaction& transaction, double sign) {
+        ledger.spending.adjust(transaction.payer, sign * transaction.amount);
+        globalSpending.adjust(transaction.payer, sign * transaction.amount);
+        
+        if (transaction.isSettled) return;
+        
+        vector<double> shares = participantShares(transaction);
+        for (size_t i = 0; i < shares.size(); i++) {
+            ledger.balances.adjust(transaction.participants[i], -sign * shares[i]);
+            globalBalances.adjust(transaction.participants[i], -sign * shares[i]);
+        }
+        ledger.balances.adjust(transaction.payer, sign * transaction.amount);
+        globalBalances.adjust(transaction.payer, sign * transaction.amount);
+    }
+    
+    void applyToBalance(map<string, double>& netBalance, const GroupLedger& ledger) const {
+        for (const auto& transaction : ledger.transactions) {
+            if (transaction.isSettled) continue;
+            
+            // Calculate how much each person owes
+            vector<double> shares = participantShares(transaction);
+            for (size_t i = 0; i < transaction.participants.size(); i++) {
+                netBalance[transaction.participants[i]] -= shares[i];
+            }
+            
+            // Add the amount paid by the payer
+            netBalance[transaction.payer] += transaction.amount;
+        }
+        
+        // Apply settlements - subtract settled amounts from balances
+        for (const auto& settlement : ledger.settlements) {
+            // Settlement reduces the debt of the payer and the credit of the receiver
+            netBalance[settlement.from] += settlement.amount;  // Debtor paid, so their debt reduces
+            netBalance[settlement.to] -= settlement.amount;    // Creditor received, so their credit reduces
+        }
+    }
     
 public:
-    SplitWiseApp() : nextTransactionId(1) {}
+    SplitWiseApp() : nextTransactionId(1), nextSettlementSequence(1) {
+        ledgers.emplace_back("");
+    }
+    
+    int recordTransaction(const string& payer, double amount, const vector<string>& participants,
+                          const string& description, const string& groupName = "",
+                          SplitType splitType = EQUAL, const vector<double>& weights = {}) {
+        GroupLedger& ledger = ledgerFor(groupName);
+        int id = nextTransactionId++;
+        ledger.transactions.emplace_back(id, payer, amount, participants, 
+                                         description, groupName, splitType, weights);
+        transactionLedger[id] = &ledger - &ledgers[0];
+        descriptionIndex.add(id, description);
+        updateLeaderboards(ledger, ledger.transactions.back(), 1);
+        updateRollups(ledger, ledger.transactions.back(), 1);
+        return id;
+    }
+    
+    bool removeTransaction(int id) {
+        auto owner = transactionLedger.find(id);
+        if (owner == transactionLedger.end()) return false;
+        
+        // IDs are ascending within a ledger, so binary search it
+        vector<Transaction>& list = ledgers[owner->second].transactions;
+        auto it = lower_bound(list.begin(), list.end(), id,
+                              [](const Transaction& t, int value) { return t.id < value; });
+        descriptionIndex.remove(id);
+        updateLeaderboards(ledgers[owner->second], *it, -1);
+        updateRollups(ledgers[owner->second], *it, -1);
+        list.erase(it);
+        transactionLedger.erase(owner);
+        return true;
+    }
+    
+    // Settlements never create groups. One naming an unknown group keeps that
+    // name but is stored in the personal partition.
+    void recordSettlement(const string& from, const string& to, double amount, const string& groupName = "") {
+        GroupLedger& ledger = hasGroup(groupName) ? ledgerFor(groupName) : ledgers[0];
+        ledger.settlements.emplace_back(0, from, to, amount, groupName);
+        ledger.settlements.back().sequence = nextSettlementSequence++;
+        
+        ledger.balances.adjust(from, amount);
+        ledger.balances.adjust(to, -amount);
+        globalBalances.adjust(from, amount);
+        globalBalances.adjust(to, -amount);
+        
+        string month = monthBucket(ledger.settlements.back().date);
+        ledger.personMonthly[{month, from}].settledOut += amount;
+        ledger.personMonthly[{month, to}].settledIn += amount;
+    }
+    
+    // Monthly spend totals for months in [fromMonth, toMonth], for a group or
+    // summed over all groups when empty; empty bounds are open
+    map<string, MonthRollup> spendingByMonth(const string& groupName = "", const string& fromMonth = "",
+                                             const string& toMonth = "") const {
+        map<string, MonthRollup> result;
+        
+        auto rollUp = [&](const GroupLedger& ledger) {
+            auto it = ledger.monthly.lower_bound(fromMonth);
+            for (; it != ledger.monthly.end(); ++it) {
+                if (!toMonth.empty() && it->first > toMonth) break;
+                result[it->first].merge(it->second);
+            }
+        };
+        
+        if (!groupName.empty()) {
+            if (const GroupLedger* ledger = findLedger(groupName)) rollUp(*ledger);
+        } else {
+            for (const auto& ledger : ledgers) rollUp(ledger);
+        }
+        return result;
+    }
+    
+    // Per-person totals for months in [fromMonth, toMonth]; empty bounds are open
+    map<string, PersonRollup> spendingByPerson(const string& groupName = "", const string& fromMonth = "",
+                                               const string& toMonth = "") const {
+        map<string, PersonRollup> result;
+        
+        auto rollUp = [&](const GroupLedger& ledger) {
+            auto it = ledger.personMonthly.lower_bound({fromMonth, ""});
+            for (; it != ledger.personMonthly.end(); ++it) {
+                if (!toMonth.empty() && it->first.first > toMonth) break;
+                result[it->first.second].merge(it->second);
+            }
+        };
+        
+        if (!groupName.empty()) {
+            if (const GroupLedger* ledger = findLedger(groupName)) rollUp(*ledger);
+        } else {
+            for (const auto& ledger : ledgers) rollUp(ledger);
+        }
+        return result;
+    }
+    
+    // Top-K queries; an empty group name means across all groups.
+    // Debtors are reported with their (negative) balance.
+    vector<pair<string, double>> topCreditors(size_t k, const string& groupName = "") const {
+        if (groupName.empty()) return globalBalances.top(k);
+        const GroupLedger* ledger = findLedger(groupName);
+        return ledger ? ledger->balances.top(k) : vector<pair<string, double>>();
+    }
+    
+    vector<pair<string, double>> topDebtors(size_t k, const string& groupName = "") const {
+        if (groupName.empty()) return globalBalances.bottom(k);
+        const GroupLedger* ledger = findLedger(groupName);
+        return ledger ? ledger->balances.bottom(k) : vector<pair<string, double>>();
+    }
+    
+    vector<pair<string, double>> topSpenders(size_t k, const string& groupName = "") const {
+        if (groupName.empty()) return globalSpending.top(k);
+        const GroupLedger* ledger = findLedger(groupName);
+        return ledger ? ledger->spending.top(k) : vector<pair<string, double>>();
+    }
+    
+    // Transactions matching every filter in the query, in ID order
+    vector<const Transaction*> findTransactions(const TransactionQuery& query) const {
+        vector<const Transaction*> result;
+        string needle = DescriptionIndex::normalize(query.description);
+        
+        const GroupLedger* scope = nullptr;
+        if (!query.groupName.empty() || query.personalOnly) {
+            scope = findLedger(query.groupName);
+            if (!scope) return result;
+        }
+        
+        // Scanning a group's own ledger beats the index when the ledger is
+        // smaller than the rarest trigram's posting list
+        bool useIndex = DescriptionIndex::canIndex(needle) &&
+            (!scope || descriptionIndex.rarestPostingSize(needle) < scope->transactions.size());
+        
+        if (useIndex) {
+            for (int id : descriptionIndex.candidates(needle)) {
+                const Transaction* t = findTransaction(id);
+                if (t && matchesQuery(*t, query, needle)) result.push_back(t);
+            }
+        } else if (scope) {
+            for (const auto& t : scope->transactions) {
+                if (matchesQuery(t, query, needle)) result.push_back(&t);
+            }
+        } else {
+            forEachTransaction([&](const Transaction& t) {
+                if (matchesQuery(t, query, needle)) result.push_back(&t);
+            });
+        }
+        
+        return result;
+    }
     
     int getSafeInteger(const string& prompt) {
         int value;
@@ -128,17 +780,14 @@ public:
         
         string groupName = "";
         if (tolower(isGroup) == 'y') {
-            cout << "Available groups: ";
-            for (const auto& group : groups) {
-                cout << group << " ";
-            }
+            printGroups();
             cout << "\nEnter group name (or create new): ";
             cin.ignore();
             getline(cin, groupName);
             
             // Add group if doesn't exist
-            if (find(groups.begin(), groups.end(), groupName) == groups.end()) {
-                groups.push_back(groupName);
+            if (!groupName.empty() && !hasGroup(groupName)) {
+                ledgerFor(groupName);
                 cout << "Created new group: " << groupName << "\n";
             }
         }
@@ -201,11 +850,9 @@ public:
                 splitType = EQUAL;
         }
         
-        Transaction newTransaction(nextTransactionId++, payer, amount, participants, 
-                                 description, groupName, splitType, weights);
-        transactions.push_back(newTransaction);
+        int id = recordTransaction(payer, amount, participants, description, groupName, splitType, weights);
         
-        cout << "Transaction added successfully! ID: " << newTransaction.id << "\n";
+        cout << "Transaction added successfully! ID: " << id << "\n";
     }
     
     void deleteTransaction() {
@@ -214,11 +861,7 @@ public:
         
         int id = getSafeInteger("Enter transaction ID to delete: ");
         
-        auto it = find_if(transactions.begin(), transactions.end(),
-                         [id](const Transaction& t) { return t.id == id; });
-        
-        if (it != transactions.end()) {
-            transactions.erase(it);
+        if (removeTransaction(id)) {
             cout << "Transaction deleted successfully!\n";
         } else {
             cout << "Transaction not found!\n";
@@ -228,56 +871,13 @@ public:
     map<string, double> calculateNetBalance(const string& groupName = "") {
         map<string, double> netBalance;
         
-        for (const auto& transaction : transactions) {
-            if (transaction.isSettled) continue;
-            
-            // Filter by group if specified
-            if (!groupName.empty() && transaction.groupName != groupName) continue;
-            
-            double perPersonAmount = 0;
-            
-            // Calculate how much each person owes
-            switch (transaction.splitType) {
-                case EQUAL:
-                    perPersonAmount = transaction.amount / transaction.participants.size();
-                    for (const auto& participant : transaction.participants) {
-                        netBalance[participant] -= perPersonAmount;
-                    }
-                    break;
-                    
-                case PERCENTAGE:
-                    for (size_t i = 0; i < transaction.participants.size(); i++) {
-                        double owedAmount = transaction.amount * (transaction.weights[i] / 100.0);
-                        netBalance[transaction.participants[i]] -= owedAmount;
-                    }
-                    break;
-                    
-                case CUSTOM_WEIGHT:
-                    {
-                        double totalWeight = 0;
-                        for (double weight : transaction.weights) {
-                            totalWeight += weight;
-                        }
-                        for (size_t i = 0; i < transaction.participants.size(); i++) {
-                            double owedAmount = transaction.amount * (transaction.weights[i] / totalWeight);
-                            netBalance[transaction.participants[i]] -= owedAmount;
-                        }
-                    }
-                    break;
+        if (groupName.empty()) {
+            for (const auto& ledger : ledgers) {
+                applyToBalance(netBalance, ledger);
             }
-            
-            // Add the amount paid by the payer
-            netBalance[transaction.payer] += transaction.amount;
-        }
-        
-        // Apply settlements - subtract settled amounts from balances
-        for (const auto& settlement : settlements) {
-            // Filter by group if specified
-            if (!groupName.empty() && settlement.groupName != groupName) continue;
-            
-            // Settlement reduces the debt of the payer and the credit of the receiver
-            netBalance[settlement.from] += settlement.amount;  // Debtor paid, so their debt reduces
-            netBalance[settlement.to] -= settlement.amount;    // Creditor received, so their credit reduces
+        } else if (const GroupLedger* ledger = findLedger(groupName)) {
+            // Only the group's own partition is touched
+            applyToBalance(netBalance, *ledger);
         }
         
         return netBalance;
@@ -292,10 +892,7 @@ public:
         
         string groupName = "";
         if (choice == 2) {
-            cout << "Available groups: ";
-            for (const auto& group : groups) {
-                cout << group << " ";
-            }
+            printGroups();
             cout << "\nEnter group name: ";
             cin.ignore();
             getline(cin, groupName);
@@ -395,10 +992,7 @@ public:
         cin >> isGroup;
         
         if (tolower(isGroup) == 'y') {
-            cout << "Available groups: ";
-            for (const auto& group : groups) {
-                cout << group << " ";
-            }
+            printGroups();
             cout << "\nEnter group name: ";
             cin.ignore();
             getline(cin, groupName);
@@ -436,8 +1030,7 @@ public:
         }
         
         // Record settlement
-        Settlement settlement(0, from, to, amount, groupName);
-        settlements.push_back(settlement);
+        recordSettlement(from, to, amount, groupName);
         
         cout << "Settlement recorded successfully!\n";
         cout << from << " paid Rs." << amount << " to " << to;
@@ -476,12 +1069,12 @@ public:
         cout << "\n=== All Transactions ===\n";
         cout << setprecision(2) << fixed;
         
-        if (transactions.empty()) {
+        if (transactionLedger.empty()) {
             cout << "No transactions found.\n";
             return;
         }
         
-        for (const auto& transaction : transactions) {
+        forEachTransaction([&](const Transaction& transaction) {
             cout << "ID: " << transaction.id << " | " << transaction.payer 
                  << " paid Rs." << transaction.amount;
             
@@ -498,7 +1091,7 @@ public:
             cout << "\n  Date: " << transaction.date;
             cout << "\n  Status: " << (transaction.isSettled ? "Settled" : "Active") << "\n";
             cout << "----------------------------------------\n";
-        }
+        });
     }
     
     void searchTransactions() {
@@ -506,59 +1099,69 @@ public:
         cout << "1. Filter by person\n";
         cout << "2. Filter by group\n";
         cout << "3. Filter by amount range\n";
+        cout << "4. Search description\n";
         
         int choice = getSafeInteger("Enter choice: ");
         
-        vector<Transaction> filtered;
+        TransactionQuery query;
         
         switch (choice) {
             case 1: {
-                string person;
                 cout << "Enter person name: ";
                 cin.ignore();
-                getline(cin, person);
-                
-                for (const auto& t : transactions) {
-                    if (t.payer == person || 
-                        find(t.participants.begin(), t.participants.end(), person) != t.participants.end()) {
-                        filtered.push_back(t);
-                    }
-                }
+                getline(cin, query.person);
                 break;
             }
             case 2: {
-                string group;
                 cout << "Enter group name: ";
                 cin.ignore();
-                getline(cin, group);
+                getline(cin, query.groupName);
                 
-                for (const auto& t : transactions) {
-                    if (t.groupName == group) {
-                        filtered.push_back(t);
-                    }
-                }
+                // An empty name lists personal (non-group) transactions
+                query.personalOnly = query.groupName.empty();
                 break;
             }
             case 3: {
-                double minAmount = getSafeDouble("Enter minimum amount: Rs.");
-                double maxAmount = getSafeDouble("Enter maximum amount: Rs.");
+                query.minAmount = getSafeDouble("Enter minimum amount: Rs.");
+                query.maxAmount = getSafeDouble("Enter maximum amount: Rs.");
+                break;
+            }
+            case 4: {
+                cout << "Enter text to search for: ";
+                cin.ignore();
+                getline(cin, query.description);
                 
-                for (const auto& t : transactions) {
-                    if (t.amount >= minAmount && t.amount <= maxAmount) {
-                        filtered.push_back(t);
-                    }
+                cout << "Filter by person (leave blank for any): ";
+                getline(cin, query.person);
+                
+                cout << "Filter by group (leave blank for any): ";
+                getline(cin, query.groupName);
+                
+                cout << "Filter by amount range? (y/n): ";
+                char useRange;
+                cin >> useRange;
+                if (tolower(useRange) == 'y') {
+                    query.minAmount = getSafeDouble("Enter minimum amount: Rs.");
+                    query.maxAmount = getSafeDouble("Enter maximum amount: Rs.");
                 }
                 break;
             }
+            default:
+                cout << "\n=== Filtered Results ===\n";
+                cout << "No transactions found matching the criteria.\n";
+                return;
         }
         
+        vector<const Transaction*> filtered = findTransactions(query);
+        
         cout << "\n=== Filtered Results ===\n";
         if (filtered.empty()) {
             cout << "No transactions found matching the criteria.\n";
             return;
         }
         
-        for (const auto& transaction : filtered) {
+        for (const Transaction* t : filtered) {
+            const Transaction& transaction = *t;
             cout << "ID: " << transaction.id << " | " << transaction.payer 
                  << " paid Rs." << transaction.amount;
             
@@ -581,7 +1184,7 @@ public:
         cout << setprecision(2) << fixed;
         
         bool hasTransactions = false;
-        for (const auto& transaction : transactions) {
+        forEachTransaction([&](const Transaction& transaction) {
             bool involved = (transaction.payer == person || 
                            find(transaction.participants.begin(), transaction.participants.end(), person) 
                            != transaction.participants.end());
@@ -592,32 +1195,12 @@ public:
 
                 // Calculate this person's share in the transaction
                 double personShare = 0.0;
-                switch (transaction.splitType) {
-                    case EQUAL:
-                        personShare = transaction.amount / transaction.participants.size();
-                        break;
-                    case PERCENTAGE:
-                        for (size_t i = 0; i < transaction.participants.size(); i++) {
-                            if (transaction.participants[i] == person) {
-                                personShare = transaction.amount * (transaction.weights[i] / 100.0);
-                                break;
-                            }
-                        }
-                        break;
-                    case CUSTOM_WEIGHT:
-                        {
-                            double totalWeight = 0;
-                            for (double weight : transaction.weights) {
-                                totalWeight += weight;
-                            }
-                            for (size_t i = 0; i < transaction.participants.size(); i++) {
-                                if (transaction.participants[i] == person) {
-                                    personShare = transaction.amount * (transaction.weights[i] / totalWeight);
-                                    break;
-                                }
-                            }
-                        }
+                vector<double> shares = participantShares(transaction);
+                for (size_t i = 0; i < transaction.participants.size(); i++) {
+                    if (transaction.participants[i] == person) {
+                        personShare = shares[i];
                         break;
+                    }
                 }
 
                 if (transaction.payer == person) {
@@ -637,7 +1220,7 @@ public:
                 cout << "\n  Description: " << transaction.description << "\n";
                 cout << "----------------------------------------\n";
             }
-        }
+        });
         
         if (!hasTransactions) {
             cout << "No transactions found for " << person << ".\n";
@@ -664,12 +1247,17 @@ public:
         cout << "\n=== Settlement History ===\n";
         cout << setprecision(2) << fixed;
         
-        if (settlements.empty()) {
+        bool hasSettlements = false;
+        for (const auto& ledger : ledgers) {
+            if (!ledger.settlements.empty()) hasSettlements = true;
+        }
+        
+        if (!hasSettlements) {
             cout << "No settlements recorded yet.\n";
             return;
         }
         
-        for (const auto& settlement : settlements) {
+        forEachSettlement([&](const Settlement& settlement) {
             cout << settlement.from << " ---> " << settlement.to 
                  << ": Rs." << settlement.amount;
             
@@ -681,6 +1269,96 @@ public:
             
             cout << "\n  Date: " << settlement.date << "\n";
             cout << "----------------------------------------\n";
+        });
+    }
+    
+    void showLeaderboards() {
+        cout << "\n--- Leaderboards ---\n";
+        cout << "1. Overall\n";
+        cout << "2. Group\n";
+        
+        int choice = getSafeInteger("Enter choice: ");
+        
+        string groupName = "";
+        if (choice == 2) {
+            printGroups();
+            cout << "\nEnter group name: ";
+            cin.ignore();
+            getline(cin, groupName);
+            
+            if (!hasGroup(groupName)) {
+                cout << "Group not found!\n";
+                return;
+            }
+        }
+        
+        int k = getSafeInteger("How many entries to show: ");
+        if (k <= 0) k = 5;
+        
+        cout << setprecision(2) << fixed;
+        
+        cout << "\n=== Owed the Most ===\n";
+        for (const auto& entry : topCreditors(k, groupName)) {
+            cout << entry.first << ": Gets Rs." << entry.second << "\n";
+        }
+        
+        cout << "\n=== Owe the Most ===\n";
+        for (const auto& entry : topDebtors(k, groupName)) {
+            cout << entry.first << ": Owes Rs." << -entry.second << "\n";
+        }
+        
+        cout << "\n=== Top Spenders ===\n";
+        for (const auto& entry : topSpenders(k, groupName)) {
+            cout << entry.first << ": Paid Rs." << entry.second << "\n";
+        }
+    }
+    
+    void showSpendingReport() {
+        cout << "\n--- Spending Reports ---\n";
+        cout << "1. All spending\n";
+        cout << "2. Group spending\n";
+        
+        int choice = getSafeInteger("Enter choice: ");
+        
+        string groupName = "";
+        if (choice == 2) {
+            printGroups();
+            cout << "\nEnter group name: ";
+            cin.ignore();
+            getline(cin, groupName);
+            
+            if (!hasGroup(groupName)) {
+                cout << "Group not found!\n";
+                return;
+            }
+        }
+        
+        cout << setprecision(2) << fixed;
+        
+        cout << "\n=== Spend by Month ===\n";
+        map<string, MonthRollup> months = spendingByMonth(groupName);
+        for (const auto& month : months) {
+            const MonthRollup& cell = month.second;
+            if (cell.transactionCount == 0) continue;
+            
+            cout << month.first << ": Rs." << cell.totalSpend 
+                 << " over " << cell.transactionCount << " transaction(s)\n";
+            cout << "  Equal: Rs." << cell.spendBySplitType[EQUAL]
+                 << " | Percentage: Rs." << cell.spendBySplitType[PERCENTAGE]
+                 << " | Custom: Rs." << cell.spendBySplitType[CUSTOM_WEIGHT] << "\n";
+        }
+        
+        cout << "\n=== Paid vs Consumed ===\n";
+        map<string, PersonRollup> people = spendingByPerson(groupName);
+        for (const auto& person : people) {
+            const PersonRollup& cell = person.second;
+            if (fabs(cell.paid) < 0.01 && fabs(cell.consumed) < 0.01 &&
+                cell.settledOut < 0.01 && cell.settledIn < 0.01) continue;
+            
+            cout << person.first << ": Paid Rs." << cell.paid 
+                 << " | Share Rs." << cell.consumed
+                 << " | Settled out Rs." << cell.settledOut
+                 << " | Settled in Rs." << cell.settledIn << "\n";
         }
     }
     
@@ -695,7 +1373,9 @@ public:
         cout << "7.  Search/Filter Transactions\n";
         cout << "8.  Personal Transaction View\n";
         cout << "9.  Settlement History\n";
-        cout << "10. Exit\n";
+        cout << "10. Leaderboards\n";
+        cout << "11. Spending Reports\n";
+        cout << "12. Exit\n";
         cout << "===============================\n";
     }
     
@@ -724,10 +1404,7 @@ public:
                         int minChoice = getSafeInteger("Enter choice: ");
                         
                         if (minChoice == 2) {
-                            cout << "Available groups: ";
-                            for (const auto& group : groups) {
-                                cout << group << " ";
-                            }
+                            printGroups();
                             cout << "\nEnter group name: ";
                             string groupName;
                             cin.ignore();
@@ -754,6 +1431,12 @@ public:
                     showSettlementHistory();
                     break;
                 case 10:
+                    showLeaderboards();
+                    break;
+                case 11:
+                    showSpendingReport();
+                    break;
+                case 12:
                     cout << "Thank you for using SplitWise Clone!\n";
                     return;
                 default:
@@ -767,8 +1450,310 @@ public:
     }
 };
 
-int main() {
+// Replays a trace of operations against SplitWiseApp and reports latency percentiles.
+//
+// Trace format, one operation per line ("-" means personal / no group):
+//   add <payer> <amount> <group> <participant,participant,...> <description...>
+//   delete <id>
+//   settle <from> <to> <amount> <group>
+//   balance <group>
+//   search <group> <text...>
+//   minimize <group>
+class WorkloadReplay {
+private:
+    struct Operation {
+        string kind;
+        vector<string> args;
+        string text;
+    };
+    
+    // Accepts and discards output; replayed timings exclude any display cost
+    struct NullBuffer : streambuf {
+        int overflow(int c) override { return c; }
+    };
+    
+    SplitWiseApp& app;
+    vector<Operation> operations;
+    map<string, vector<double>> latencies; // op kind -> microseconds
+    
+    static string groupArg(const string& arg) {
+        return arg == "-" ? "" : arg;
+    }
+    
+    static Operation parse(const string& line) {
+        Operation op;
+        stringstream ss(line);
+        ss >> op.kind;
+        
+        size_t fixedArgs = (op.kind == "add" || op.kind == "settle") ? 4 : 1;
+        
+        string arg;
+        while (op.args.size() < fixedArgs && ss >> arg) {
+            op.args.push_back(arg);
+        }
+        getline(ss >> ws, op.text);
+        return op;
+    }
+    
+    static vector<string> splitParticipants(const string& arg) {
+        vector<string> participants;
+        stringstream ss(arg);
+        string participant;
+        while (getline(ss, participant, ',')) {
+            if (!participant.empty()) participants.push_back(participant);
+        }
+        return participants;
+    }
+    
+    // True if the whole of text is a finite number of type T
+    template <typename T>
+    static bool isNumber(const string& text) {
+        stringstream ss(text);
+        T value;
+        return ss >> value && (ss >> ws).eof() && isfinite(static_cast<double>(value));
+    }
+    
+    // Checks everything execute relies on, so a bad trace line never throws mid-run
+    static bool isValid(const Operation& op) {
+        if (op.kind == "add") {
+            return op.args.size() == 4 && isNumber<double>(op.args[1]) &&
+                   !splitParticipants(op.args[3]).empty();
+        }
+        if (op.kind == "settle") {
+            return op.args.size() == 4 && isNumber<double>(op.args[2]);
+        }
+        if (op.kind == "delete") {
+            return op.args.size() == 1 && isNumber<int>(op.args[0]);
+        }
+        if (op.kind == "balance" || op.kind == "search" || op.kind == "minimize") {
+            return op.args.size() == 1;
+        }
+        return false;
+    }
+    
+    void execute(const Operation& op) {
+        if (op.kind == "add") {
+            vector<string> participants = splitParticipants(op.args[3]);
+            app.recordTransaction(op.args[0], stod(op.args[1]), participants, op.text, groupArg(op.args[2]));
+        } else if (op.kind == "delete") {
+            app.removeTransaction(stoi(op.args[0]));
+        } else if (op.kind == "settle") {
+            // Mirrors settleDebt: overall balances, validation, record, updated balances
+            string groupName = groupArg(op.args[3]);
+            app.calculateNetBalance();
+            app.calculateNetBalance(groupName);
+            app.recordSettlement(op.args[0], op.args[1], stod(op.args[2]), groupName);
+            app.calculateNetBalance(groupName);
+        } else if (op.kind == "balance") {
+            app.calculateNetBalance(groupArg(op.args[0]));
+        } else if (op.kind == "search") {
+            TransactionQuery query;
+            query.groupName = groupArg(op.args[0]);
+            query.description = op.text;
+            app.findTransactions(query);
+        } else if (op.kind == "minimize") {
+            app.minimizeTransactions(groupArg(op.args[0]));
+        }
+    }
+    
+    static double percentile(const vector<double>& sorted, double p) {
+        if (sorted.empty()) return 0;
+        size_t rank = static_cast<size_t>(ceil(p * sorted.size()));
+        return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+    }
+    
+    static long peakRssKb() {
+#if defined(__APPLE__)
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024; // bytes on macOS
+#elif defined(__unix__)
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;        // kilobytes on Linux
+#else
+        return -1;
+#endif
+    }
+    
+public:
+    WorkloadReplay(SplitWiseApp& _app) : app(_app) {}
+    
+    bool loadTrace(const string& path) {
+        ifstream in(path);
+        if (!in) return false;
+        
+        string line;
+        int lineNumber = 0;
+        while (getline(in, line)) {
+            lineNumber++;
+            if (line.empty() || line[0] == '#') continue;
+            
+            Operation op = parse(line);
+            if (!isValid(op)) {
+                cout << "Skipping malformed trace line " << lineNumber << ": " << line << "\n";
+                continue;
+            }
+            operations.push_back(op);
+        }
+        return true;
+    }
+    
+    // Builds a seeded mixed workload over groups of very different sizes
+    void generateSynthetic(int count, unsigned seed = 42) {
+        mt19937 rng(seed);
+        const int people = 500;
+        const int groups = 200;
+        const vector<string> words = {"dinner", "uber", "groceries", "rent", "movie", "coffee",
+                                      "flight", "hotel", "lunch", "petrol", "snacks", "tickets"};
+        
+        // Zipf-like group popularity: a few huge groups, a long tail of small ones
+        vector<double> groupWeights;
+        for (int g = 1; g <= groups; g++) groupWeights.push_back(1.0 / g);
+        discrete_distribution<int> pickGroup(groupWeights.begin(), groupWeights.end());
+        uniform_int_distribution<int> pickPerson(0, people - 1);
+        uniform_int_distribution<int> pickPercent(0, 99);
+        
+        auto person = [&]() { return "P" + to_string(pickPerson(rng)); };
+        auto group = [&]() { return pickPercent(rng) < 20 ? string("-") : "G" + to_string(pickGroup(rng)); };
+        
+        int nextId = 1;
+        vector<int> liveIds;
+        
+        for (int i = 0; i < count; i++) {
+            int roll = pickPercent(rng);
+            Operation op;
+            
+            if (roll < 45 || liveIds.empty()) {
+                string payer = person();
+                string participants = payer;
+                int extra = 1 + pickPercent(rng) % 5;
+                for (int j = 0; j < extra; j++) participants += "," + person();
+                
+                op.kind = "add";
+                op.args = {payer, to_string(1 + pickPercent(rng) * 25), group(), participants};
+                op.text = words[pickPercent(rng) % words.size()] + " " + words[pickPercent(rng) % words.size()];
+                liveIds.push_back(nextId++);
+            } else if (roll < 50) {
+                size_t victim = rng() % liveIds.size();
+                op.kind = "delete";
+                op.args = {to_string(liveIds[victim])};
+                liveIds[victim] = liveIds.back();
+                liveIds.pop_back();
+            } else if (roll < 60) {
+                op.kind = "settle";
+                op.args = {person(), person(), to_string(1 + pickPercent(rng)), group()};
+            } else if (roll < 80) {
+                op.kind = "balance";
+                op.args = {pickPercent(rng) < 10 ? string("-") : group()};
+            } else if (roll < 95) {
+                op.kind = "search";
+                op.args = {pickPercent(rng) < 50 ? string("-") : group()};
+                op.text = words[pickPercent(rng) % words.size()];
+            } else {
+                op.kind = "minimize";
+                op.args = {group()};
+            }
+            
+            operations.push_back(op);
+        }
+    }
+    
+    bool saveTrace(const string& path) const {
+        ofstream out(path);
+        if (!out) return false;
+        
+        for (const auto& op : operations) {
+            out << op.kind;
+            for (const auto& arg : op.args) out << " " << arg;
+            if (!op.text.empty()) out << " " << op.text;
+            out << "\n";
+        }
+        return true;
+    }
+    
+    // Runs the loaded operations; opsPerSecond <= 0 means as fast as possible.
+    // With a target rate, latency is measured from each operation's scheduled
+    // start, so time spent queued behind a slow operation is counted.
+    void run(double opsPerSecond) {
+        using Clock = chrono::steady_clock;
+        
+        // minimizeTransactions prints its plan; keep it out of the report
+        NullBuffer devNull;
+        streambuf* original = cout.rdbuf(&devNull);
+        
+        Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < operations.size(); i++) {
+            Clock::time_point scheduled = start;
+            if (opsPerSecond > 0) {
+                scheduled += chrono::duration_cast<Clock::duration>(chrono::duration<double>(i / opsPerSecond));
+                this_thread::sleep_until(scheduled);
+            } else {
+                scheduled = Clock::now();
+            }
+            
+            execute(operations[i]);
+            
+            double micros = chrono::duration<double, micro>(Clock::now() - scheduled).count();
+            latencies[operations[i].kind].push_back(micros);
+        }
+        double elapsed = chrono::duration<double>(Clock::now() - start).count();
+        
+        cout.rdbuf(original);
+        
+        cout << "\n=== Replay Report ===\n";
+        cout << "Operations: " << operations.size() << " in " << setprecision(3) << fixed << elapsed << "s";
+        if (elapsed > 0) cout << " (" << setprecision(1) << operations.size() / elapsed << " ops/s)";
+        if (opsPerSecond > 0) cout << ", target " << opsPerSecond << " ops/s";
+        cout << "\n\n";
+        
+        cout << left << setw(10) << "op" << right << setw(9) << "count"
+             << setw(12) << "p50(us)" << setw(12) << "p95(us)" << setw(12) << "p99(us)"
+             << setw(12) << "p999(us)" << setw(12) << "max(us)" << "\n";
+        
+        for (auto& entry : latencies) {
+            vector<double>& samples = entry.second;
+            sort(samples.begin(), samples.end());
+            cout << left << setw(10) << entry.first << right << setw(9) << samples.size()
+                 << setprecision(1)
+                 << setw(12) << percentile(samples, 0.50) << setw(12) << percentile(samples, 0.95)
+                 << setw(12) << percentile(samples, 0.99) << setw(12) << percentile(samples, 0.999)
+                 << setw(12) << samples.back() << "\n";
+        }
+        
+        long rss = peakRssKb();
+        cout << "\nPeak RSS: ";
+        if (rss >= 0) cout << rss << " KB\n";
+        else cout << "unavailable\n";
+    }
+};
+
+int main(int argc, char* argv[]) {
     SplitWiseApp app;
+    
+    // splitwise --replay <trace-file> [ops-per-sec]
+    // splitwise --synthetic <op-count> [ops-per-sec] [trace-out]
+    if (argc >= 3 && (string(argv[1]) == "--replay" || string(argv[1]) == "--synthetic")) {
+        WorkloadReplay replay(app);
+        double rate = argc >= 4 ? atof(argv[3]) : 0;
+        
+        if (string(argv[1]) == "--replay") {
+            if (!replay.loadTrace(argv[2])) {
+                cout << "Could not read trace file: " << argv[2] << "\n";
+                return 1;
+            }
+        } else {
+            replay.generateSynthetic(atoi(argv[2]));
+            if (argc >= 5 && !replay.saveTrace(argv[4])) {
+                cout << "Could not write trace file: " << argv[4] << "\n";
+                return 1;
+            }
+        }
+        
+        replay.run(rate);
+        return 0;
+    }
+    
     app.run();
     return 0;
 }